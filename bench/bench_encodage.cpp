@@ -0,0 +1,110 @@
+//
+//  bench_encodage.cpp
+//
+//
+//  Created by Anaelle Ji-Seun Joo on 18/10/2026.
+//
+
+// Micro-benchmark des noyaux d'encodage 2 bits
+// Chaque noyau disponible est d'abord comparé à la version scalaire
+// (longueurs et décalages variés), puis son débit est mesuré en GB/s
+
+#include "encodage_nucleotides.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+struct Noyau {
+    const char* nom;
+    NoyauEncodage fonction;
+};
+
+// Séquence aléatoire avec environ 1 % de bases invalides (N, minuscules, IUPAC)
+static string sequenceAleatoire(size_t n, mt19937_64& generateur) {
+    const char bases[] = "ACGT";
+    const char invalides[] = "NacgtRYn-";
+    string s(n, 'A');
+    for (size_t i = 0; i < n; i++) {
+        uint64_t r = generateur();
+        s[i] = (r % 100 == 0) ? invalides[(r >> 8) % 9] : bases[(r >> 8) % 4];
+    }
+    return s;
+}
+
+// Compare un noyau à la version scalaire sur toutes les longueurs 0..300
+// et plusieurs décalages (chargements non alignés)
+static bool verifierNoyau(const Noyau& noyau, const string& s) {
+    for (size_t decalage = 0; decalage < 8; decalage++) {
+        for (size_t n = 0; n <= 300; n++) {
+            vector<uint64_t> codesRef((n + 31) / 32 + 1, 0), invRef((n + 63) / 64 + 1, 0);
+            vector<uint64_t> codes((n + 31) / 32 + 1, 0), inv((n + 63) / 64 + 1, 0);
+            encoderBasesScalaire(s.data() + decalage, n, codesRef.data(), invRef.data());
+            noyau.fonction(s.data() + decalage, n, codes.data(), inv.data());
+            if (codes != codesRef || inv != invRef) {
+                cerr << "🙈 Erreur : " << noyau.nom << " diffère du scalaire (n = " << n
+                     << ", décalage = " << decalage << ")" << endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Débit d'un noyau en GB/s (octets de séquence lus par seconde)
+static double mesurerDebit(const Noyau& noyau, const string& s, int repetitions) {
+    size_t n = s.length();
+    vector<uint64_t> codes((n + 31) / 32), inv((n + 63) / 64);
+    double meilleur = 1e30;
+    for (int r = 0; r < repetitions; r++) {
+        fill(codes.begin(), codes.end(), 0);
+        fill(inv.begin(), inv.end(), 0);
+        auto debut = chrono::steady_clock::now();
+        noyau.fonction(s.data(), n, codes.data(), inv.data());
+        double temps = chrono::duration<double>(chrono::steady_clock::now() - debut).count();
+        meilleur = min(meilleur, temps);
+    }
+    return n / meilleur / 1e9;
+}
+
+int main(int argc, char* argv[]) {
+    size_t taille = (argc > 1) ? stoul(argv[1]) : (64u << 20);  // 64 Mo par défaut
+    int repetitions = (argc > 2) ? stoi(argv[2]) : 10;
+
+    mt19937_64 generateur(42);
+    vector<Noyau> noyaux = {{"scalaire", encoderBasesScalaire}};
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse4.2")) noyaux.push_back({"sse4.2", encoderBasesSSE42});
+    if (__builtin_cpu_supports("avx2")) noyaux.push_back({"avx2", encoderBasesAVX2});
+#endif
+
+    cout << "=== Micro-benchmark de l'encodage 2 bits ===" << endl;
+    cout << "  Noyau choisi à l'exécution : " << nomNoyauEncodage() << endl << endl;
+
+    // Vérification contre la version scalaire
+    string petite = sequenceAleatoire(400, generateur);
+    petite.replace(50, 70, 70, 'N');  // une longue série invalide
+    for (size_t i = 1; i < noyaux.size(); i++) {
+        if (!verifierNoyau(noyaux[i], petite)) {
+            return 1;
+        }
+        cout << "  " << noyaux[i].nom << " : identique au scalaire" << endl;
+    }
+    cout << endl;
+
+    // Mesure du débit
+    string s = sequenceAleatoire(taille, generateur);
+    cout << "  Séquence de " << taille << " octets, meilleur temps sur "
+         << repetitions << " répétitions" << endl;
+    for (const Noyau& noyau : noyaux) {
+        cout << "  " << left << setw(10) << noyau.nom << fixed << setprecision(2)
+             << mesurerDebit(noyau, s, repetitions) << " GB/s" << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,47 @@
+//
+//  assemblage_shards.hpp
+//
+//
+//  Created by Anaelle Ji-Seun Joo on 18/10/2026.
+//
+
+#ifndef assemblage_shards_hpp
+#define assemblage_shards_hpp
+
+#include <string>
+#include <vector>
+#include <utility>  // Pour std::pair
+#include <cstdint>
+
+// Statistiques de charge d'un shard
+struct StatsShard {
+    long kmers = 0;           // k-mers attribués au shard
+    long arcs = 0;            // arcs internes calculés par le worker
+    long arcsFrontiere = 0;   // arcs vers un autre shard, résolus par le coordinateur
+    double temps = 0.0;       // temps de calcul du worker (secondes)
+};
+
+// Valeur de hachage du minimiseur d'un k-mer
+// kmer : le k-mer
+// m : taille des m-mers comparés (m <= longueur du k-mer)
+// Retourne : plus petite valeur de hachage parmi les m-mers du k-mer
+uint64_t minimiseur(const std::string& kmer, int m);
+
+// Calcule les arcs du graphe de De Bruijn avec un processus worker par shard
+// Les k-mers sont répartis entre les shards selon leur minimiseur ; chaque
+// worker ne cherche les successeurs que parmi les k-mers de son shard et
+// transmet par fichier ceux qui relèvent d'un autre shard. Le coordinateur
+// résout ces arcs de frontière et fusionne les arcs dans l'ordre de calculArcs
+// L : liste triée de k-mers
+// k : taille des k-mers
+// nbShards : nombre de shards (et de processus workers)
+// dossier : dossier des fichiers d'échange (doit exister)
+// A : liste des arcs fusionnés (sortie)
+// stats : statistiques de charge de chaque shard (sortie)
+// Retourne : true si tous les workers ont terminé correctement
+bool calculArcsShardes(const std::vector<std::string>& L, int k, int nbShards,
+                       const std::string& dossier,
+                       std::vector<std::pair<int, int>>& A,
+                       std::vector<StatsShard>& stats);
+
+#endif /* assemblage_shards_hpp */
@@ -11,6 +11,7 @@
 #include <string>
 #include <vector>
 #include <utility>  // Pour std::pair
+#include <array>
 
 // Recherche un k-mer dans une liste triée
 // kmer : le k-mer à rechercher
@@ -18,6 +19,13 @@
 // Retourne : l'indice du k-mer dans L, ou -1 s'il n'est pas trouvé
 int rechercher(const std::string& kmer, const std::vector<std::string>& L);
 
+// Successeurs possibles d'un k-mer : son suffixe de longueur k-1 suivi de
+// A, C, G puis T (partagé par calculArcs et le calcul shardé)
+// kmer : le k-mer source
+// k : taille des k-mers
+// Retourne : les quatre k-mers suivants, dans l'ordre des bases
+std::array<std::string, 4> kmersSuivants(const std::string& kmer, int k);
+
 // Calcule les arcs du graphe de De Bruijn
 // L : liste de k-mers (ordre alphabétique)
 // k : taille des k-mers
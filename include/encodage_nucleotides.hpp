@@ -0,0 +1,57 @@
+//
+//  encodage_nucleotides.hpp
+//
+//
+//  Created by Anaelle Ji-Seun Joo on 18/10/2026.
+//
+
+#ifndef encodage_nucleotides_hpp
+#define encodage_nucleotides_hpp
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Encodage 2 bits des bases : A = 0, C = 1, G = 2, T = 3
+// codes : 32 bases par mot, la base i occupe les bits 2*(i%32) et 2*(i%32)+1
+//         du mot i/32 (les bases invalides sont codées 0)
+// invalides : 64 bases par mot, le bit i%64 du mot i/64 vaut 1 si la base i
+//             n'est pas A, C, G ou T (N, IUPAC, minuscules)
+
+// Noyau d'encodage : les tableaux de sortie doivent être remis à zéro et
+// contenir au moins (n+31)/32 mots (codes) et (n+63)/64 mots (invalides)
+typedef void (*NoyauEncodage)(const char* sequence, size_t n,
+                              uint64_t* codes, uint64_t* invalides);
+
+// Implémentations disponibles
+void encoderBasesScalaire(const char* sequence, size_t n, uint64_t* codes, uint64_t* invalides);
+#if defined(__x86_64__) || defined(__i386__)
+void encoderBasesSSE42(const char* sequence, size_t n, uint64_t* codes, uint64_t* invalides);
+void encoderBasesAVX2(const char* sequence, size_t n, uint64_t* codes, uint64_t* invalides);
+#endif
+
+// Noyau choisi selon le processeur (AVX2, sinon SSE4.2, sinon scalaire)
+NoyauEncodage noyauEncodage();
+
+// Nom du noyau choisi ("avx2", "sse4.2" ou "scalaire")
+const char* nomNoyauEncodage();
+
+// Encode une séquence avec le noyau choisi
+// sequence : séquence à encoder
+// codes, invalides : redimensionnés et remplis (voir format ci-dessus)
+void encoderSequence(const std::string& sequence,
+                     std::vector<uint64_t>& codes,
+                     std::vector<uint64_t>& invalides);
+
+// Code 2 bits de la base i d'une séquence encodée
+inline uint64_t baseCodee(const std::vector<uint64_t>& codes, size_t i) {
+    return (codes[i / 32] >> (2 * (i % 32))) & 3;
+}
+
+// Vrai si la base i d'une séquence encodée n'est pas A, C, G ou T
+inline bool baseInvalide(const std::vector<uint64_t>& invalides, size_t i) {
+    return (invalides[i / 64] >> (i % 64)) & 1;
+}
+
+#endif /* encodage_nucleotides_hpp */
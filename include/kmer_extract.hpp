@@ -10,6 +10,7 @@
 
 #include <string>
 #include <vector>
+#include <cstdint>
 
 // Trie une liste de k-mers par ordre alphabétique
 std::vector<std::string> trier(std::vector<std::string> unsorted_list);
@@ -20,4 +21,23 @@ std::vector<std::string> trier(std::vector<std::string> unsorted_list);
 // Retourne : liste triée de k-mers
 std::vector<std::string> kmerExtract(int k, const std::vector<std::string>& F);
 
+// Marque les bases à écarter d'une séquence
+// Une base est écartée si ce n'est pas A, C, G ou T, ou si sa qualité
+// (caractère Phred+33, entre 0 et 93) est strictement inférieure à qualiteMin
+// sequence : séquence du read
+// qualites : chaîne de qualité de même longueur (vide = pas de filtre qualité)
+// invalides : masque de bits au format de encoderSequence (bit à 1 = base écartée,
+//             voir baseInvalide) ; réutilisé d'un read à l'autre par l'appelant
+void masqueBasesValides(const std::string& sequence, const std::string& qualites,
+                        int qualiteMin, std::vector<uint64_t>& invalides);
+
+// Extrait les k-mers ne contenant que des bases valides (voir masqueBasesValides)
+// k : taille des k-mers
+// F : ensemble de séquences (reads)
+// Q : qualités associées à F (vide pour un fichier FASTA)
+// qualiteMin : qualité Phred minimale d'une base
+// Retourne : liste triée de k-mers
+std::vector<std::string> kmerExtract(int k, const std::vector<std::string>& F,
+                                     const std::vector<std::string>& Q, int qualiteMin);
+
 #endif /* kmer_extract_hpp */
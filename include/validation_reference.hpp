@@ -0,0 +1,71 @@
+//
+//  validation_reference.hpp
+//
+//
+//  Created by Anaelle Ji-Seun Joo on 18/10/2026.
+//
+
+#ifndef validation_reference_hpp
+#define validation_reference_hpp
+
+#include <string>
+#include <vector>
+#include <utility>  // Pour std::pair
+#include <cstdint>
+
+// Index des k-mers (graines) d'une séquence de référence
+// Chaque graine est codée sur 2 bits par base (première base en poids fort,
+// l'ordre des codes est donc l'ordre alphabétique) ; les paires
+// (graine, position) sont triées
+struct IndexReference {
+    int tailleGraine = 0;          // au plus 16 bases
+    long longueurReference = 0;
+    std::vector<std::pair<uint32_t, int>> graines;
+    // Référence encodée (voir encodage_nucleotides.hpp), pour l'extension des blocs
+    std::vector<uint64_t> codesReference;
+    std::vector<uint64_t> invalidesReference;
+};
+
+// Bloc d'alignement colinéaire d'un contig sur la référence
+struct BlocAlignement {
+    int debutContig;    // Coordonnées sur le brin direct du contig [debut, fin)
+    int finContig;
+    int debutReference; // Coordonnées sur la référence [debut, fin)
+    int finReference;
+    bool brinInverse;   // true si le contig s'aligne en reverse-complément
+};
+
+// Statistiques de validation d'un assemblage contre une référence
+struct StatsValidation {
+    int nombreContigs = 0;
+    long longueurTotale = 0;
+    long longueurReference = 0;
+    long n50 = 0;
+    long nga50 = 0;
+    double fractionGenome = 0.0;     // en pourcentage
+    int misassemblages = 0;
+    double ratioDuplication = 0.0;
+    long longueurNonAlignee = 0;
+};
+
+// Construit l'index des graines de longueur tailleGraine (<= 16) de la référence
+// (les bases en minuscules, masquées par soft-masking, sont indexées comme les majuscules)
+IndexReference construireIndex(const std::string& reference, int tailleGraine);
+
+// Aligne un contig sur la référence : chaînage de graines colinéaires, puis
+// extension par alignement en bande ; les blocs d'identité < 95 % sont écartés
+// Retourne : blocs d'alignement triés selon leur position dans le contig
+std::vector<BlocAlignement> alignerContig(const std::string& contig,
+                                          const IndexReference& index);
+
+// Aligne tous les contigs et calcule les statistiques
+// Chaque brin de chaque contig est une tâche : un contig unique est aligné
+// sur deux threads
+// contigs : séquences assemblées
+// index : index de la référence
+// nbThreads : nombre de threads (0 = nombre de cœurs disponibles)
+StatsValidation validerAssemblage(const std::vector<std::string>& contigs,
+                                  const IndexReference& index,
+                                  int nbThreads = 0);
+
+#endif /* validation_reference_hpp */
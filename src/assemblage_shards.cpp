@@ -0,0 +1,243 @@
+//
+//  assemblage_shards.cpp
+//
+//
+//  Created by Anaelle Ji-Seun Joo on 18/10/2026.
+//
+
+#include "assemblage_shards.hpp"
+#include "calcul_arcs.hpp"
+#include "encodage_nucleotides.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace std;
+
+// Taille maximale des m-mers utilisés comme minimiseurs
+static const int TAILLE_MINIMISEUR = 15;
+
+// Mélange des bits d'un m-mer encodé (évite le biais vers les poly-A)
+static uint64_t hacher(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+// Minimiseur d'un k-mer : m-mers glissants sur les codes 2 bits de encoderSequence
+// (les bases autres que A, C, G, T valent 0)
+uint64_t minimiseur(const string& kmer, int m) {
+    // Tampons réutilisés d'un appel à l'autre (un jeu par thread)
+    static thread_local vector<uint64_t> codes, invalides;
+    encoderSequence(kmer, codes, invalides);
+
+    int n = kmer.length();
+    m = max(1, min(m, n));
+    uint64_t masque = (m >= 32) ? ~0ULL : ((1ULL << (2 * m)) - 1);
+    uint64_t code = 0;
+    uint64_t meilleur = ~0ULL;
+
+    for (int i = 0; i < n; i++) {
+        code = ((code << 2) | baseCodee(codes, i)) & masque;
+        if (i >= m - 1) {
+            meilleur = min(meilleur, hacher(code));
+        }
+    }
+    return meilleur;
+}
+
+// Shard d'un k-mer, selon son minimiseur
+static int shardDe(const string& kmer, int m, int nbShards) {
+    return minimiseur(kmer, m) % nbShards;
+}
+
+// Nom du fichier d'échange d'un shard
+// Le pid du coordinateur distingue les exécutions concurrentes dans un même dossier
+static string fichierShard(const string& dossier, pid_t coordinateur, int s) {
+    return dossier + "/arcs_" + to_string(coordinateur) + "_" + to_string(s) + ".bin";
+}
+
+// Écrit un tableau de paires précédé de sa taille
+static bool ecrirePaires(FILE* f, const vector<pair<int, int>>& P) {
+    long n = P.size();
+    return fwrite(&n, sizeof(n), 1, f) == 1 &&
+           (n == 0 || fwrite(P.data(), sizeof(pair<int, int>), n, f) == (size_t)n);
+}
+
+// Lit un tableau de paires précédé de sa taille
+static bool lirePaires(FILE* f, vector<pair<int, int>>& P) {
+    long n = 0;
+    if (fread(&n, sizeof(n), 1, f) != 1 || n < 0) {
+        return false;
+    }
+    P.resize(n);
+    return n == 0 || fread(P.data(), sizeof(pair<int, int>), n, f) == (size_t)n;
+}
+
+// Travail d'un worker sur le shard s
+// Le worker construit son graphe partiel à partir des seuls k-mers du shard
+// (liste triée locale) : un successeur dont le minimiseur désigne le shard
+// est cherché localement, sinon une demande (source, base) est transmise au
+// coordinateur
+// Format du fichier : temps (double), arcs locaux, puis demandes de frontière
+static bool executerWorker(const vector<string>& L, int k, int s, int nbShards, int m,
+                           const vector<int>& indices, const string& fichier) {
+    auto debut = chrono::steady_clock::now();
+
+    // L est trié : la sous-liste du shard l'est aussi
+    vector<string> Ls;
+    Ls.reserve(indices.size());
+    for (int i : indices) {
+        Ls.push_back(L[i]);
+    }
+
+    vector<pair<int, int>> arcsLocaux;
+    vector<pair<int, int>> demandes;
+    for (size_t li = 0; li < Ls.size(); li++) {
+        array<string, 4> suivants = kmersSuivants(Ls[li], k);
+        for (int b = 0; b < 4; b++) {
+            const string& kmer_suivant = suivants[b];
+            if (shardDe(kmer_suivant, m, nbShards) != s) {
+                demandes.push_back(make_pair(indices[li], b));
+                continue;
+            }
+            int lj = rechercher(kmer_suivant, Ls);
+            if (lj != -1) {
+                arcsLocaux.push_back(make_pair(indices[li], indices[lj]));
+            }
+        }
+    }
+    double temps = chrono::duration<double>(chrono::steady_clock::now() - debut).count();
+
+    FILE* f = fopen(fichier.c_str(), "wb");
+    if (f == nullptr) {
+        return false;
+    }
+    bool ok = fwrite(&temps, sizeof(temps), 1, f) == 1 &&
+              ecrirePaires(f, arcsLocaux) && ecrirePaires(f, demandes);
+    return fclose(f) == 0 && ok;
+}
+
+// Relit le fichier d'échange d'un shard
+static bool lireShard(const string& fichier, vector<pair<int, int>>& arcsLocaux,
+                      vector<pair<int, int>>& demandes, double& temps) {
+    FILE* f = fopen(fichier.c_str(), "rb");
+    if (f == nullptr) {
+        return false;
+    }
+    bool ok = fread(&temps, sizeof(temps), 1, f) == 1 &&
+              lirePaires(f, arcsLocaux) && lirePaires(f, demandes);
+    fclose(f);
+    remove(fichier.c_str());
+    return ok;
+}
+
+// Attend les workers encore en cours et supprime les fichiers d'échange
+static void abandonnerShards(const vector<pid_t>& workers, const string& dossier,
+                             pid_t coordinateur) {
+    for (size_t s = 0; s < workers.size(); s++) {
+        if (workers[s] > 0) {
+            waitpid(workers[s], nullptr, 0);
+        }
+        remove(fichierShard(dossier, coordinateur, s).c_str());
+    }
+}
+
+// CalculArcs en mode shardé
+// Les workers sont des processus fils (fork) : chacun calcule les arcs internes
+// à son shard et renvoie par fichier les successeurs qui tombent dans un autre
+// shard ; le coordinateur résout ces arcs de frontière et fusionne le tout
+bool calculArcsShardes(const vector<string>& L, int k, int nbShards,
+                       const string& dossier,
+                       vector<pair<int, int>>& A,
+                       vector<StatsShard>& stats) {
+    A.clear();
+    stats.assign(nbShards, StatsShard());
+
+    // Répartition des k-mers par minimiseur : deux k-mers consécutifs d'un
+    // chemin partagent k-1 bases, donc le plus souvent le même minimiseur
+    int m = min(TAILLE_MINIMISEUR, max(1, k - 1));
+    vector<vector<int>> indices(nbShards);
+    for (size_t i = 0; i < L.size(); i++) {
+        indices[shardDe(L[i], m, nbShards)].push_back(i);
+    }
+
+    // Le tampon de sortie est vidé pour ne pas être dupliqué dans les workers
+    cout.flush();
+    cerr.flush();
+
+    // Relevé avant le fork : les workers nomment leurs fichiers d'après leur parent
+    pid_t coordinateur = getpid();
+    vector<pid_t> workers(nbShards, -1);
+    for (int s = 0; s < nbShards; s++) {
+        string fichier = fichierShard(dossier, coordinateur, s);
+        pid_t pid = fork();
+        if (pid == 0) {
+            bool ok = executerWorker(L, k, s, nbShards, m, indices[s], fichier);
+            _exit(ok ? 0 : 1);
+        }
+        if (pid < 0) {
+            cerr << "  ⚠️  Avertissement : fork impossible, shard " << s
+                 << " calculé par le coordinateur" << endl;
+            if (!executerWorker(L, k, s, nbShards, m, indices[s], fichier)) {
+                cerr << "🙈 Erreur : échec du calcul du shard " << s << endl;
+                abandonnerShards(workers, dossier, coordinateur);
+                return false;
+            }
+        }
+        workers[s] = pid;
+    }
+
+    // Attente des workers
+    bool ok = true;
+    for (int s = 0; s < nbShards; s++) {
+        if (workers[s] <= 0) continue;
+        int statut = 0;
+        if (waitpid(workers[s], &statut, 0) < 0 || !WIFEXITED(statut) || WEXITSTATUS(statut) != 0) {
+            cerr << "🙈 Erreur : le worker du shard " << s << " a échoué" << endl;
+            ok = false;
+        }
+        workers[s] = -1;
+    }
+    if (!ok) {
+        abandonnerShards(workers, dossier, coordinateur);
+        return false;
+    }
+
+    // Fusion : arcs internes des shards, puis arcs de frontière résolus
+    // par le coordinateur dans la liste globale
+    for (int s = 0; s < nbShards; s++) {
+        vector<pair<int, int>> arcsLocaux, demandes;
+        if (!lireShard(fichierShard(dossier, coordinateur, s), arcsLocaux, demandes, stats[s].temps)) {
+            cerr << "🙈 Erreur : lecture impossible des arcs du shard " << s << endl;
+            abandonnerShards(workers, dossier, coordinateur);
+            return false;
+        }
+        stats[s].kmers = indices[s].size();
+        stats[s].arcs = arcsLocaux.size();
+        A.insert(A.end(), arcsLocaux.begin(), arcsLocaux.end());
+
+        for (const auto& demande : demandes) {
+            int j = rechercher(kmersSuivants(L[demande.first], k)[demande.second], L);
+            if (j != -1) {
+                A.push_back(make_pair(demande.first, j));
+                stats[s].arcsFrontiere++;
+            }
+        }
+    }
+
+    // Ordre global identique à calculArcs : par k-mer source, puis par base
+    // (les successeurs d'une même source sont triés comme leur dernière base)
+    sort(A.begin(), A.end());
+    return true;
+}
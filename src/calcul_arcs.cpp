@@ -7,6 +7,7 @@
 
 #include "calcul_arcs.hpp"
 #include <algorithm>
+#include <array>
 #include <string>
 #include <vector>
 #include <utility>
@@ -24,24 +25,31 @@ int rechercher(const string& kmer, const vector<string>& L) {
     return -1;
 }
 
+// Successeurs possibles d'un k-mer (suffixe + A, C, G, T)
+array<string, 4> kmersSuivants(const string& kmer, int k) {
+    char bases[] = {'A', 'C', 'G', 'T'}; //alphabet
+
+    std::string suffixe = kmer.substr(1, k - 1); // récupérer (substring) le suffixe longueur k-1 du k-mer courant (lomgueur du chevauchement)
+
+    array<string, 4> suivants;
+    for (int b = 0; b < 4; b++) { // pour chaque base
+        suivants[b] = suffixe + bases[b]; // suffixe + 'X' pour voir si c'est le prefixe d'un kmer dans L
+    }
+    return suivants;
+}
+
 // CalculArcs
 // Entrée : L : liste triée de k-mers (ordre alphabétique), k : entier
 // Sortie : A : liste des arcs (paires d'indices des k-mers)
 
 vector<pair<int, int>> calculArcs(const vector<string>& L, int k) {
     vector<pair<int, int>> A;  // A <- liste vide
-    char bases[] = {'A', 'C', 'G', 'T'}; //alphabet
     
     // Pour chaque k-mer dans L
     for (size_t i = 0; i < L.size(); i++) { //pour i de 0 a |L|-1, i : indice du kmer courant
 
-        std::string suffixe = L[i].substr(1, k - 1); // récupérer (substring) le suffixe longueur k-1 du k-mer courant (lomgueur du chevauchement)
-        
         // Tester chaque base pour voir si elle forme un k-mer existant
-        for (char X : bases) { // pour chaque base
-            // Construire le k-mer suivant potentiel
-            string kmer_suivant = suffixe + X; // suffixe + 'X' pour voir si c'est le prefixe d'un kmer dans L
-            
+        for (const string& kmer_suivant : kmersSuivants(L[i], k)) { // pour chaque base
             // Chercher si ce k-mer existe dans L
             int j = rechercher(kmer_suivant, L); //retourne l'indice du kmer chevauchant s'il exitse
             
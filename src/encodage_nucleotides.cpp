@@ -0,0 +1,153 @@
+//
+//  encodage_nucleotides.cpp
+//
+//
+//  Created by Anaelle Ji-Seun Joo on 18/10/2026.
+//
+
+#include "encodage_nucleotides.hpp"
+#include <string>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+// Encode les bases debut..n-1 une à une (fin de séquence des noyaux SIMD)
+// Les mots de sortie sont complétés par OU binaire
+static void encoderBasesDepuis(const char* sequence, size_t debut, size_t n,
+                               uint64_t* codes, uint64_t* invalides) {
+    for (size_t i = debut; i < n; i++) {
+        uint64_t code = 0;
+        bool valide = true;
+        switch (sequence[i]) {
+            case 'A': code = 0; break;
+            case 'C': code = 1; break;
+            case 'G': code = 2; break;
+            case 'T': code = 3; break;
+            default:  valide = false; break;
+        }
+        codes[i / 32] |= code << (2 * (i % 32));
+        if (!valide) {
+            invalides[i / 64] |= 1ULL << (i % 64);
+        }
+    }
+}
+
+// Version scalaire de référence
+void encoderBasesScalaire(const char* sequence, size_t n, uint64_t* codes, uint64_t* invalides) {
+    encoderBasesDepuis(sequence, 0, n, codes, invalides);
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+// Principe des noyaux SIMD, pour chaque octet c :
+//   - valide = (c == 'A') | (c == 'C') | (c == 'G') | (c == 'T')
+//   - code = table[c & 0x0F] (pshufb) : A=0x41, C=0x43, G=0x47, T=0x54
+//     donnent les indices 1, 3, 7 et 4 ; les octets invalides sont mis à 0
+//   - les codes sont regroupés 4 par octet : maddubs (c0 + 4*c1) puis
+//     madd (+ 16*(c2 + 4*c3)), enfin réduction 32 -> 8 bits par pack
+
+// Encode 16 bases : 4 entiers 32 bits (4 bases chacun) et masque des invalides
+__attribute__((target("sse4.2")))
+static inline __m128i encoder16(__m128i bases, uint32_t& invalides) {
+    const __m128i table = _mm_setr_epi8(0, 0, 0, 1, 3, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0);
+    __m128i valide = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(bases, _mm_set1_epi8('A')), _mm_cmpeq_epi8(bases, _mm_set1_epi8('C'))),
+        _mm_or_si128(_mm_cmpeq_epi8(bases, _mm_set1_epi8('G')), _mm_cmpeq_epi8(bases, _mm_set1_epi8('T'))));
+    invalides = ~(uint32_t)_mm_movemask_epi8(valide) & 0xFFFF;
+
+    __m128i code = _mm_shuffle_epi8(table, _mm_and_si128(bases, _mm_set1_epi8(0x0F)));
+    code = _mm_and_si128(code, valide);
+    __m128i paires = _mm_maddubs_epi16(code, _mm_set1_epi16(0x0401));
+    return _mm_madd_epi16(paires, _mm_set1_epi32(0x00100001));
+}
+
+// Noyau SSE4.2 : 32 bases (un mot de codes) par itération
+__attribute__((target("sse4.2")))
+void encoderBasesSSE42(const char* sequence, size_t n, uint64_t* codes, uint64_t* invalides) {
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        uint32_t inv0, inv1;
+        __m128i d0 = encoder16(_mm_loadu_si128((const __m128i*)(sequence + i)), inv0);
+        __m128i d1 = encoder16(_mm_loadu_si128((const __m128i*)(sequence + i + 16)), inv1);
+        __m128i octets = _mm_packus_epi16(_mm_packs_epi32(d0, d1), _mm_setzero_si128());
+        _mm_storel_epi64((__m128i*)(codes + i / 32), octets);
+        invalides[i / 64] |= (uint64_t)(inv0 | (inv1 << 16)) << (i % 64);
+    }
+    encoderBasesDepuis(sequence, i, n, codes, invalides);
+}
+
+// Encode 32 bases : 8 entiers 32 bits (16 bases par voie de 128 bits)
+__attribute__((target("avx2")))
+static inline __m256i encoder32(__m256i bases, uint32_t& invalides) {
+    const __m256i table = _mm256_setr_epi8(0, 0, 0, 1, 3, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0,
+                                           0, 0, 0, 1, 3, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0);
+    __m256i valide = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(bases, _mm256_set1_epi8('A')), _mm256_cmpeq_epi8(bases, _mm256_set1_epi8('C'))),
+        _mm256_or_si256(_mm256_cmpeq_epi8(bases, _mm256_set1_epi8('G')), _mm256_cmpeq_epi8(bases, _mm256_set1_epi8('T'))));
+    invalides = ~(uint32_t)_mm256_movemask_epi8(valide);
+
+    __m256i code = _mm256_shuffle_epi8(table, _mm256_and_si256(bases, _mm256_set1_epi8(0x0F)));
+    code = _mm256_and_si256(code, valide);
+    __m256i paires = _mm256_maddubs_epi16(code, _mm256_set1_epi16(0x0401));
+    return _mm256_madd_epi16(paires, _mm256_set1_epi32(0x00100001));
+}
+
+// Noyau AVX2 : 64 bases (deux mots de codes, un mot d'invalides) par itération
+__attribute__((target("avx2")))
+void encoderBasesAVX2(const char* sequence, size_t n, uint64_t* codes, uint64_t* invalides) {
+    // Les packs travaillent par voie de 128 bits : après packus, les groupes de
+    // 16 bases sont dans l'ordre 0, 2, -, -, 1, 3 (en mots de 32 bits)
+    const __m256i ordre = _mm256_setr_epi32(0, 4, 1, 5, 0, 0, 0, 0);
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        uint32_t inv0, inv1;
+        __m256i d0 = encoder32(_mm256_loadu_si256((const __m256i*)(sequence + i)), inv0);
+        __m256i d1 = encoder32(_mm256_loadu_si256((const __m256i*)(sequence + i + 32)), inv1);
+        __m256i octets = _mm256_packus_epi16(_mm256_packs_epi32(d0, d1), _mm256_setzero_si256());
+        octets = _mm256_permutevar8x32_epi32(octets, ordre);
+        _mm_storeu_si128((__m128i*)(codes + i / 32), _mm256_castsi256_si128(octets));
+        invalides[i / 64] = (uint64_t)inv0 | ((uint64_t)inv1 << 32);
+    }
+    encoderBasesDepuis(sequence, i, n, codes, invalides);
+}
+
+#endif
+
+// Choix du noyau selon les extensions supportées par le processeur
+static NoyauEncodage choisirNoyau() {
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return encoderBasesAVX2;
+    }
+    if (__builtin_cpu_supports("sse4.2")) {
+        return encoderBasesSSE42;
+    }
+#endif
+    return encoderBasesScalaire;
+}
+
+// Noyau choisi une seule fois, au premier appel
+NoyauEncodage noyauEncodage() {
+    static const NoyauEncodage noyau = choisirNoyau();
+    return noyau;
+}
+
+const char* nomNoyauEncodage() {
+#if defined(__x86_64__) || defined(__i386__)
+    if (noyauEncodage() == encoderBasesAVX2) return "avx2";
+    if (noyauEncodage() == encoderBasesSSE42) return "sse4.2";
+#endif
+    return "scalaire";
+}
+
+// Encode une séquence avec le noyau choisi
+void encoderSequence(const string& sequence, vector<uint64_t>& codes, vector<uint64_t>& invalides) {
+    size_t n = sequence.length();
+    codes.assign((n + 31) / 32, 0);
+    invalides.assign((n + 63) / 64, 0);
+    noyauEncodage()(sequence.data(), n, codes.data(), invalides.data());
+}
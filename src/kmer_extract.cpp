@@ -6,9 +6,13 @@
 //
 
 #include "kmer_extract.hpp"
+#include "encodage_nucleotides.hpp"
 #include <algorithm>
 #include <vector>
 #include <string>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 using namespace std;
 
@@ -41,3 +45,75 @@ std::vector<string> kmerExtract(int k, const std::vector<string>& F) {
     
     return L;
 }
+
+// Ajoute aux mots de invalides (64 bases par mot) les bases de qualité < seuil
+// Sur x86-64, les qualités sont comparées par blocs de 16 (SSE2), la fin de
+// la chaîne (et les autres architectures) passe par la boucle scalaire
+static void marquerBasseQualite(const string& qualites, unsigned char seuil,
+                                std::vector<uint64_t>& invalides) {
+    size_t n = qualites.length();
+    const unsigned char* q = (const unsigned char*)qualites.data();
+    size_t j = 0;
+    
+#ifdef __SSE2__
+    // Les caractères Phred+33 sont < 128 : la comparaison signée suffit
+    const __m128i vecteurSeuil = _mm_set1_epi8((char)seuil);
+    for (; j + 16 <= n; j += 16) {
+        __m128i qual = _mm_loadu_si128((const __m128i*)(q + j));
+        uint64_t basses = (unsigned)_mm_movemask_epi8(_mm_cmplt_epi8(qual, vecteurSeuil));
+        invalides[j / 64] |= basses << (j % 64);
+    }
+#endif
+    
+    for (; j < n; j++) {
+        if (q[j] < seuil) {
+            invalides[j / 64] |= 1ULL << (j % 64);
+        }
+    }
+}
+
+// Marque les bases valides d'une séquence
+// Les bases autres que A, C, G, T viennent du masque de encoderSequence
+void masqueBasesValides(const string& sequence, const string& qualites,
+                        int qualiteMin, std::vector<uint64_t>& invalides) {
+    // Les codes 2 bits ne servent pas ici : tampon réutilisé (un par thread)
+    static thread_local std::vector<uint64_t> codes;
+    encoderSequence(sequence, codes, invalides);
+    
+    if (qualites.length() == sequence.length()) {
+        // Seuil borné pour rester dans la plage des caractères Phred+33
+        unsigned char seuil = (unsigned char)min(max(qualiteMin, 0), 93) + 33;
+        marquerBasseQualite(qualites, seuil, invalides);
+    }
+}
+
+// KmerExtract avec filtre qualité
+// Entrée :
+//   k : un entier (taille des k-mers)
+//   F : un ensemble de mots, Q : leurs qualités, qualiteMin : seuil Phred
+// Sortie : une liste triée des k-mers de F sans base invalide
+std::vector<string> kmerExtract(int k, const std::vector<string>& F,
+                                const std::vector<string>& Q, int qualiteMin) {
+    std::vector<string> L;  // Liste de k-mers
+    std::vector<uint64_t> invalides;  // réutilisé d'un read à l'autre
+    
+    // Pour chaque séquence dans F
+    for (size_t i = 0; i < F.size(); i++) {
+        masqueBasesValides(F[i], i < Q.size() ? Q[i] : string(), qualiteMin, invalides);
+        
+        // Longueur de la série de bases valides se terminant en j :
+        // une base invalide coupe la série et tous les k-mers qui la chevauchent
+        int serie = 0;
+        for (size_t j = 0; j < F[i].length(); j++) {
+            serie = baseInvalide(invalides, j) ? 0 : serie + 1;
+            if (serie >= k) {
+                L.push_back(F[i].substr(j + 1 - k, k));
+            }
+        }
+    }
+    
+    // Trier la liste de k-mers
+    L = trier(L);
+    
+    return L;
+}
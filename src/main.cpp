@@ -16,11 +16,14 @@
 #include "calcul_arcs.hpp"
 #include "graphe_bruijn.hpp"
 #include "chemin_eulerien.hpp"
+#include "validation_reference.hpp"
+#include "assemblage_shards.hpp"
 #include <iostream>
 #include <fstream>
 #include <vector>
 #include <string>
 #include <ctime>
+#include <chrono>
 #include <sys/resource.h>
 #include <sys/stat.h>
 #include <iomanip>
@@ -66,7 +69,10 @@ string formatTime(double seconds) {
 }
 
 // Fonction pour lire les séquences depuis un fichier FASTQ
-vector<string> lireFastq(const string& nomFichier) {
+// Si qualites n'est pas nul, les chaînes de qualité (ligne 4 de chaque bloc)
+// y sont stockées ; un enregistrement dont la qualité n'a pas la longueur de
+// la séquence (fichier tronqué ou mal formé) est alors ignoré
+vector<string> lireFastq(const string& nomFichier, vector<string>* qualites = nullptr) {
     vector<string> sequences;
     ifstream fichier(nomFichier);
     
@@ -77,15 +83,33 @@ vector<string> lireFastq(const string& nomFichier) {
     
     string ligne;
     int numLigne = 0;
+    int readsIgnores = 0;
     
     while (getline(fichier, ligne)) {
         numLigne++;
         // Dans un fichier FASTQ, la séquence est sur la ligne 2 de chaque bloc de 4 lignes
         if (numLigne % 4 == 2) {
-            sequences.push_back(ligne);
+            sequences.push_back(move(ligne));
+        } else if (numLigne % 4 == 0 && qualites != nullptr) {
+            if (ligne.length() == sequences.back().length()) {
+                qualites->push_back(move(ligne));
+            } else {
+                sequences.pop_back();
+                readsIgnores++;
+            }
         }
     }
     
+    // Dernier enregistrement sans ligne de qualité
+    if (qualites != nullptr && sequences.size() > qualites->size()) {
+        readsIgnores += sequences.size() - qualites->size();
+        sequences.resize(qualites->size());
+    }
+    if (readsIgnores > 0) {
+        cerr << "  ⚠️  Avertissement : " << readsIgnores
+             << " read(s) ignoré(s), qualité absente ou de longueur différente de la séquence" << endl;
+    }
+    
     fichier.close();
     return sequences;
 }
@@ -158,22 +182,55 @@ int main(int argc, char* argv[]) {
     string fichierEntree = "reads.fastq.fq";
     string fichierSortie = "out.fa";
     int k = 21;  // Taille des k-mers
-    
-    // Lecture des arguments
-    if (argc > 1) {
-        fichierEntree = argv[1];
+    string fichierReference = "";  // Référence pour la validation (optionnelle)
+    int qualiteMin = -1;  // Qualité Phred minimale des bases (-1 = pas de filtre)
+    int nbShards = 1;     // Nombre de processus workers pour le calcul des arcs
+    
+    // Lecture des arguments : options "--nom valeur" puis arguments positionnels
+    vector<string> positionnels;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--reference" && i + 1 < argc) {
+            fichierReference = argv[++i];
+        } else if (arg == "--min-base-quality" && i + 1 < argc) {
+            qualiteMin = stoi(argv[++i]);
+        } else if (arg == "--shards" && i + 1 < argc) {
+            nbShards = stoi(argv[++i]);
+            if (nbShards < 1) {
+                cerr << "🙈 Erreur : le nombre de shards doit être >= 1" << endl;
+                return 1;
+            }
+        } else if (arg.rfind("--", 0) == 0) {
+            cerr << "🙈 Erreur : option inconnue ou incomplète " << arg << endl;
+            return 1;
+        } else {
+            positionnels.push_back(arg);
+        }
+    }
+    if (positionnels.size() > 0) {
+        fichierEntree = positionnels[0];
     }
-    if (argc > 2) {
-        k = stoi(argv[2]);
+    if (positionnels.size() > 1) {
+        k = stoi(positionnels[1]);
     }
-    if (argc > 3) {
-        fichierSortie = argv[3];
+    if (positionnels.size() > 2) {
+        fichierSortie = positionnels[2];
     }
     
     cout << "Paramètres :" << endl;
     cout << "  Fichier d'entrée : " << fichierEntree << endl;
     cout << "  Taille des k-mers (k) : " << k << endl;
-    cout << "  Fichier de sortie : " << fichierSortie << endl << endl;
+    cout << "  Fichier de sortie : " << fichierSortie << endl;
+    if (!fichierReference.empty()) {
+        cout << "  Référence : " << fichierReference << endl;
+    }
+    if (qualiteMin >= 0) {
+        cout << "  Qualité minimale des bases : " << qualiteMin << endl;
+    }
+    if (nbShards > 1) {
+        cout << "  Shards (processus workers) : " << nbShards << endl;
+    }
+    cout << endl;
     
     // Créer le dossier de résultats
     string dossierResultats = "resultats";
@@ -184,11 +241,13 @@ int main(int argc, char* argv[]) {
     cout << "Étape 1 : Lecture des séquences..." << endl;
     clock_t temps1 = clock();
     vector<string> sequences;
+    vector<string> qualites;  // Vide pour un fichier FASTA ou sans filtre qualité
     
     // Déterminer le type de fichier
     if (fichierEntree.find(".fastq") != string::npos || 
         fichierEntree.find(".fq") != string::npos) {
-        sequences = lireFastq(fichierEntree);
+        // Les qualités ne sont conservées que si le filtre qualité est actif
+        sequences = lireFastq(fichierEntree, qualiteMin >= 0 ? &qualites : nullptr);
     } else {
         sequences = lireFasta(fichierEntree);
     }
@@ -205,7 +264,17 @@ int main(int argc, char* argv[]) {
     // Étape 2 : Extraction des k-mers
     cout << "Étape 2 : Extraction des k-mers..." << endl;
     clock_t temps2 = clock();
-    vector<string> kmers = kmerExtract(k, sequences);
+    vector<string> kmers;
+    if (qualiteMin >= 0) {
+        // Les k-mers chevauchant une base N ou de qualité insuffisante sont ignorés
+        kmers = kmerExtract(k, sequences, qualites, qualiteMin);
+    } else {
+        kmers = kmerExtract(k, sequences);
+    }
+    if (kmers.empty()) {
+        cerr << "🙈 Erreur : aucun k-mer extrait" << endl;
+        return 1;
+    }
     cout << "  " << kmers.size() << " k-mers extraits et triés" << endl;
     double temps2Ecoule = (double)(clock() - temps2) / CLOCKS_PER_SEC;
     cout << "    Temps : " << formatTime(temps2Ecoule) << endl;
@@ -242,10 +311,43 @@ int main(int argc, char* argv[]) {
     
     // Étape 3 : Calcul des arcs
     cout << "Étape 3 : Calcul des arcs du graphe..." << endl;
-    clock_t temps3 = clock();
-    vector<pair<int, int>> arcs = calculArcs(kmers, k);
+    // Temps réel : le temps CPU du processus n'inclut pas celui des workers (fork)
+    auto temps3 = chrono::steady_clock::now();
+    vector<pair<int, int>> arcs;
+    if (nbShards > 1) {
+        // Un worker par shard (arcs internes), arcs de frontière résolus ensuite
+        string dossierShards = dossierResultats + "/shards";
+        creerDossier(dossierShards);
+        vector<StatsShard> statsShards;
+        if (!calculArcsShardes(kmers, k, nbShards, dossierShards, arcs, statsShards)) {
+            cerr << "🙈 Erreur : échec du calcul shardé des arcs" << endl;
+            return 1;
+        }
+        
+        // Équilibre de charge : rapport entre le shard le plus chargé et la moyenne
+        long maxKmers = 0, totalFrontiere = 0;
+        double maxTemps = 0.0, totalTemps = 0.0;
+        cout << "  Shard\tK-mers\tInternes\tFrontière\tTemps" << endl;
+        for (int s = 0; s < nbShards; s++) {
+            const StatsShard& st = statsShards[s];
+            cout << "  " << s << "\t" << st.kmers << "\t" << st.arcs << "\t\t"
+                 << st.arcsFrontiere << "\t\t" << formatTime(st.temps) << endl;
+            maxKmers = max(maxKmers, st.kmers);
+            maxTemps = max(maxTemps, st.temps);
+            totalFrontiere += st.arcsFrontiere;
+            totalTemps += st.temps;
+        }
+        double moyenneKmers = (double)kmers.size() / nbShards;
+        double moyenneTemps = totalTemps / nbShards;
+        cout << "  Déséquilibre (max/moyenne) : k-mers " << fixed << setprecision(2)
+             << maxKmers / moyenneKmers << ", temps "
+             << (moyenneTemps > 0 ? maxTemps / moyenneTemps : 1.0) << endl;
+        cout << "  Arcs de frontière résolus par le coordinateur : " << totalFrontiere << endl;
+    } else {
+        arcs = calculArcs(kmers, k);
+    }
     cout << "  " << arcs.size() << " arcs calculés" << endl;
-    double temps3Ecoule = (double)(clock() - temps3) / CLOCKS_PER_SEC;
+    double temps3Ecoule = chrono::duration<double>(chrono::steady_clock::now() - temps3).count();
     cout << "    Temps : " << formatTime(temps3Ecoule) << endl;
     
     // Écriture des arcs dans un fichier TSV
@@ -346,6 +448,30 @@ int main(int argc, char* argv[]) {
     }
     ecrireFasta(fichierSortieFinal, sequenceAssemblee);
     
+    // Étape 7 (optionnelle) : Validation des contigs contre la référence
+    bool validationFaite = false;
+    StatsValidation validation;
+    if (!fichierReference.empty()) {
+        cout << endl << "Étape 7 : Validation contre la référence..." << endl;
+        clock_t temps7 = clock();
+        vector<string> references = lireFasta(fichierReference);
+        if (references.empty()) {
+            cerr << "  ⚠️  Avertissement : aucune séquence de référence lue, validation ignorée" << endl;
+        } else {
+            // Les séquences de référence sont concaténées, séparées par un N
+            string reference = references[0];
+            for (size_t i = 1; i < references.size(); i++) {
+                reference += 'N' + references[i];
+            }
+            IndexReference index = construireIndex(reference, 15);
+            cout << "  Index de " << index.graines.size() << " graines construit" << endl;
+            validation = validerAssemblage(vector<string>(1, sequenceAssemblee), index);
+            validationFaite = true;
+        }
+        double temps7Ecoule = (double)(clock() - temps7) / CLOCKS_PER_SEC;
+        cout << "    Temps : " << formatTime(temps7Ecoule) << endl;
+    }
+    
     // Calcul des statistiques finales
     clock_t tempsFin = clock();
     double tempsTotal = (double)(tempsFin - tempsDebut) / CLOCKS_PER_SEC;
@@ -360,6 +486,21 @@ int main(int argc, char* argv[]) {
     cout << " Mémoire maximale : " << fixed << setprecision(2) << memoireFin << " MB" << endl;
     cout << "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━" << endl;
     
+    if (validationFaite) {
+        cout << endl << "VALIDATION CONTRE LA RÉFÉRENCE" << endl;
+        cout << "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━" << endl;
+        cout << " Contigs : " << validation.nombreContigs << endl;
+        cout << " Longueur totale : " << validation.longueurTotale << " bases" << endl;
+        cout << " Longueur de la référence : " << validation.longueurReference << " bases" << endl;
+        cout << " N50 : " << validation.n50 << endl;
+        cout << " NGA50 : " << (validation.nga50 > 0 ? to_string(validation.nga50) : "-") << endl;
+        cout << " Fraction du génome : " << fixed << setprecision(3) << validation.fractionGenome << " %" << endl;
+        cout << " Misassemblages : " << validation.misassemblages << endl;
+        cout << " Longueur non alignée : " << validation.longueurNonAlignee << " bases" << endl;
+        cout << " Ratio de duplication : " << fixed << setprecision(3) << validation.ratioDuplication << endl;
+        cout << "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━" << endl;
+    }
+    
     cout << endl << "📁 FICHIERS GÉNÉRÉS" << endl;
     cout << "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━" << endl;
     cout << dossierResultats << "/kmers_sorted.fasta - K-mers triés (FASTA)" << endl;
@@ -0,0 +1,403 @@
+//
+//  validation_reference.cpp
+//
+//
+//  Created by Anaelle Ji-Seun Joo on 18/10/2026.
+//
+
+#include "validation_reference.hpp"
+#include "encodage_nucleotides.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// Écart de diagonale toléré entre deux graines d'un même bloc (petits indels)
+static const int ECART_INDEL = 20;
+// Distance sans graine compatible au-delà de laquelle un bloc est clos
+static const int TROU_MAX = 150;
+// Longueur minimale d'un bloc d'alignement retenu
+static const int LONGUEUR_MIN_BLOC = 100;
+// Écart de diagonale entre deux blocs consécutifs signalant un misassemblage
+static const int ECART_MISASSEMBLAGE = 1000;
+// Identité minimale d'un bloc après extension (seuil par défaut de QUAST)
+static const double IDENTITE_MIN = 0.95;
+// Part alignée minimale d'un contig pour compter ses misassemblages (comme
+// QUAST, un contig surtout non aligné n'est pas compté comme misassemblé)
+static const double PART_ALIGNEE_MISASSEMBLAGE = 0.5;
+// Demi-largeur de la bande de l'alignement d'extension, au-delà de l'écart
+// de longueur entre les deux segments
+static const int DEMI_BANDE = 2 * ECART_INDEL;
+
+// Séquence en majuscules : les régions masquées en minuscules (soft-masking)
+// des fichiers FASTA restent ainsi indexées et alignées
+static string enMajuscules(const string& s) {
+    string majuscules(s);
+    for (char& c : majuscules) {
+        c = toupper((unsigned char)c);
+    }
+    return majuscules;
+}
+
+// Reverse-complément d'une séquence
+static string reverseComplement(const string& s) {
+    string rc(s.rbegin(), s.rend());
+    for (char& c : rc) {
+        switch (c) {
+            case 'A': c = 'T'; break;
+            case 'C': c = 'G'; break;
+            case 'G': c = 'C'; break;
+            case 'T': c = 'A'; break;
+            default:  c = 'N'; break;
+        }
+    }
+    return rc;
+}
+
+// Graines valides d'une séquence encodée : paires (graine codée, position)
+// triées par position ; une base invalide (N...) coupe les graines qui la contiennent
+static vector<pair<uint32_t, int>> grainesSequence(const vector<uint64_t>& codes,
+                                                   const vector<uint64_t>& invalides,
+                                                   size_t longueur, int g) {
+    vector<pair<uint32_t, int>> graines;
+    uint32_t masque = (g >= 16) ? ~0u : ((1u << (2 * g)) - 1);
+    uint32_t graine = 0;
+    int serie = 0;  // bases valides consécutives
+    for (size_t i = 0; i < longueur; i++) {
+        graine = ((graine << 2) | (uint32_t)baseCodee(codes, i)) & masque;
+        serie = baseInvalide(invalides, i) ? 0 : serie + 1;
+        if (serie >= g) {
+            graines.push_back(make_pair(graine, (int)(i + 1 - g)));
+        }
+    }
+    return graines;
+}
+
+// Vrai si la base i de a et la base j de b sont identiques et valides
+static inline bool basesEgales(const vector<uint64_t>& codesA, const vector<uint64_t>& invA, size_t i,
+                               const vector<uint64_t>& codesB, const vector<uint64_t>& invB, size_t j) {
+    return !baseInvalide(invA, i) && !baseInvalide(invB, j) &&
+           baseCodee(codesA, i) == baseCodee(codesB, j);
+}
+
+// Distance d'édition entre a[debutA, debutA+n) et b[debutB, debutB+m),
+// calculée dans une bande autour de la diagonale (n, m)
+static int distanceBande(const vector<uint64_t>& codesA, const vector<uint64_t>& invA, size_t debutA, int n,
+                         const vector<uint64_t>& codesB, const vector<uint64_t>& invB, size_t debutB, int m) {
+    const int INFINI = 1 << 29;
+    // Bornes de j - i dans la bande
+    int bas = min(0, m - n) - DEMI_BANDE;
+    int haut = max(0, m - n) + DEMI_BANDE;
+
+    vector<int> precedente(m + 1, INFINI), courante(m + 1, INFINI);
+    for (int j = 0; j <= min(m, haut); j++) {
+        precedente[j] = j;
+    }
+    for (int i = 1; i <= n; i++) {
+        int jMin = max(0, i + bas);
+        int jMax = min(m, i + haut);
+        for (int j = jMin; j <= jMax; j++) {
+            int v = INFINI;
+            if (j == 0) {
+                v = i;
+            } else {
+                int diagonaleOk = basesEgales(codesA, invA, debutA + i - 1, codesB, invB, debutB + j - 1);
+                v = precedente[j - 1] + (diagonaleOk ? 0 : 1);
+                if (j - 1 >= jMin) {
+                    v = min(v, courante[j - 1] + 1);
+                }
+            }
+            if (j <= i - 1 + haut) {
+                v = min(v, precedente[j] + 1);
+            }
+            courante[j] = v;
+        }
+        swap(precedente, courante);
+    }
+    return precedente[m];
+}
+
+// Diagonale d'un bloc, exprimée dans le repère du brin aligné
+static long diagonale(const BlocAlignement& b, int longueurContig) {
+    int debutBrin = b.brinInverse ? longueurContig - b.finContig : b.debutContig;
+    return (long)b.debutReference - debutBrin;
+}
+
+// Construit l'index des graines de la référence
+IndexReference construireIndex(const string& reference, int tailleGraine) {
+    IndexReference index;
+    index.tailleGraine = min(max(tailleGraine, 1), 16);
+    index.longueurReference = reference.length();
+    encoderSequence(enMajuscules(reference), index.codesReference, index.invalidesReference);
+    index.graines = grainesSequence(index.codesReference, index.invalidesReference,
+                                    reference.length(), index.tailleGraine);
+
+    // Tri des graines pour la recherche binaire
+    sort(index.graines.begin(), index.graines.end());
+    return index;
+}
+
+// Aligne un brin (direct ou reverse-complément) du contig
+// Les graines compatibles avec la diagonale courante prolongent le bloc,
+// un trou trop long clôt le bloc et la graine suivante en ouvre un nouveau.
+// Chaque bloc est ensuite étendu base à base (alignement en bande entre ses
+// deux graines extrêmes) et n'est retenu que si son identité atteint IDENTITE_MIN
+static vector<BlocAlignement> alignerBrin(const string& contig, bool inverse,
+                                          const IndexReference& index) {
+    vector<BlocAlignement> blocs;
+    int g = index.tailleGraine;
+    int L = contig.length();
+    if (index.graines.empty() || L < g) {
+        return blocs;
+    }
+    vector<uint64_t> codes, invalides;
+    string brin = enMajuscules(contig);
+    encoderSequence(inverse ? reverseComplement(brin) : brin, codes, invalides);
+    vector<pair<uint32_t, int>> graines = grainesSequence(codes, invalides, L, g);
+
+    bool blocOuvert = false;
+    BlocAlignement courant = {0, 0, 0, 0, inverse};
+    long diagCourante = 0;
+    int derniereGraine = 0;
+    size_t indiceDerniereGraine = 0;
+
+    // Enregistre le bloc courant s'il est assez long et assez identique
+    // à la référence (coordonnées du brin direct)
+    auto fermerBloc = [&]() {
+        int n = courant.finContig - courant.debutContig;
+        int m = courant.finReference - courant.debutReference;
+        if (blocOuvert && n >= LONGUEUR_MIN_BLOC &&
+            distanceBande(codes, invalides, courant.debutContig, n,
+                          index.codesReference, index.invalidesReference,
+                          courant.debutReference, m) <= (1.0 - IDENTITE_MIN) * max(n, m)) {
+            BlocAlignement b = courant;
+            if (inverse) {
+                b.debutContig = L - courant.finContig;
+                b.finContig = L - courant.debutContig;
+            }
+            blocs.push_back(b);
+        }
+        blocOuvert = false;
+    };
+
+    for (size_t n = 0; n < graines.size(); n++) {
+        uint32_t graine = graines[n].first;
+        int i = graines[n].second;
+        if (blocOuvert && i - derniereGraine > TROU_MAX) {
+            // Reprendre juste après la dernière graine du bloc clos
+            fermerBloc();
+            n = indiceDerniereGraine;
+            continue;
+        }
+
+        auto debut = lower_bound(index.graines.begin(), index.graines.end(), graine,
+                                 [](const pair<uint32_t, int>& a, uint32_t v) {
+                                     return a.first < v;
+                                 });
+        if (debut == index.graines.end() || debut->first != graine) continue;
+
+        if (blocOuvert) {
+            // Chercher l'occurrence la plus proche de la diagonale courante
+            long meilleurEcart = -1;
+            int meilleurePos = -1;
+            for (auto it = debut; it != index.graines.end() && it->first == graine; ++it) {
+                long ecart = labs((long)(it->second - i) - diagCourante);
+                if (meilleurEcart < 0 || ecart < meilleurEcart) {
+                    meilleurEcart = ecart;
+                    meilleurePos = it->second;
+                }
+            }
+            if (meilleurEcart <= ECART_INDEL) {
+                // Extension du bloc courant
+                courant.finContig = i + g;
+                courant.finReference = max(courant.finReference, meilleurePos + g);
+                diagCourante = meilleurePos - i;
+                derniereGraine = i;
+                indiceDerniereGraine = n;
+            }
+            continue;
+        }
+
+        // Ouverture d'un nouveau bloc sur la première occurrence
+        blocOuvert = true;
+        courant.debutContig = i;
+        courant.finContig = i + g;
+        courant.debutReference = debut->second;
+        courant.finReference = debut->second + g;
+        diagCourante = debut->second - i;
+        derniereGraine = i;
+        indiceDerniereGraine = n;
+    }
+    fermerBloc();
+    return blocs;
+}
+
+// Regroupe les blocs des deux brins, triés selon leur position dans le contig
+// Aux indels, un bloc rouvert sur une diagonale décalée recouvre la fin du bloc
+// précédent sur la référence (segment dupliqué dans le contig) : comme QUAST,
+// la partie déjà alignée est retirée du bloc suivant et reste non alignée
+static vector<BlocAlignement> fusionnerBrins(vector<BlocAlignement> direct,
+                                             const vector<BlocAlignement>& inverse) {
+    direct.insert(direct.end(), inverse.begin(), inverse.end());
+    sort(direct.begin(), direct.end(),
+         [](const BlocAlignement& a, const BlocAlignement& b) {
+             return a.debutContig < b.debutContig;
+         });
+
+    vector<BlocAlignement> blocs;
+    for (BlocAlignement bloc : direct) {
+        if (!blocs.empty() && blocs.back().brinInverse == bloc.brinInverse) {
+            const BlocAlignement& precedent = blocs.back();
+            // Le brin direct avance sur la référence, le brin inverse recule
+            int recouvrement = bloc.brinInverse
+                ? bloc.finReference - precedent.debutReference
+                : precedent.finReference - bloc.debutReference;
+            if (recouvrement > 0 && bloc.debutReference < precedent.finReference &&
+                precedent.debutReference < bloc.finReference) {
+                if (bloc.brinInverse) {
+                    bloc.finReference -= recouvrement;
+                } else {
+                    bloc.debutReference += recouvrement;
+                }
+                bloc.debutContig += recouvrement;
+                if (bloc.debutContig >= bloc.finContig ||
+                    bloc.debutReference >= bloc.finReference) {
+                    continue;
+                }
+            }
+        }
+        blocs.push_back(bloc);
+    }
+    return blocs;
+}
+
+// Aligne un contig sur les deux brins de la référence
+vector<BlocAlignement> alignerContig(const string& contig, const IndexReference& index) {
+    return fusionnerBrins(alignerBrin(contig, false, index),
+                          alignerBrin(contig, true, index));
+}
+
+// Calcule la plus petite longueur couvrant au moins la moitié de seuil
+static long calculerNx50(vector<long> longueurs, long seuil) {
+    sort(longueurs.begin(), longueurs.end(), greater<long>());
+    long cumul = 0;
+    for (long l : longueurs) {
+        cumul += l;
+        if (2 * cumul >= seuil) {
+            return l;
+        }
+    }
+    return 0;
+}
+
+// Aligne tous les contigs et calcule les statistiques de validation
+StatsValidation validerAssemblage(const vector<string>& contigs,
+                                  const IndexReference& index,
+                                  int nbThreads) {
+    StatsValidation stats;
+    stats.nombreContigs = contigs.size();
+    stats.longueurReference = index.longueurReference;
+
+    // Alignement en parallèle : une tâche par brin de chaque contig
+    // (tâche 2c : brin direct du contig c, tâche 2c+1 : reverse-complément)
+    size_t nbTaches = 2 * contigs.size();
+    vector<vector<BlocAlignement>> alignementsBrins(nbTaches);
+    if (nbThreads <= 0) {
+        nbThreads = max(1u, thread::hardware_concurrency());
+    }
+    nbThreads = max(1, min(nbThreads, (int)nbTaches));
+
+    vector<thread> threads;
+    for (int t = 0; t < nbThreads; t++) {
+        threads.emplace_back([&, t]() {
+            for (size_t tache = t; tache < nbTaches; tache += nbThreads) {
+                alignementsBrins[tache] = alignerBrin(contigs[tache / 2], tache % 2 == 1, index);
+            }
+        });
+    }
+    for (thread& th : threads) {
+        th.join();
+    }
+
+    vector<vector<BlocAlignement>> alignements(contigs.size());
+    for (size_t c = 0; c < contigs.size(); c++) {
+        alignements[c] = fusionnerBrins(alignementsBrins[2 * c], alignementsBrins[2 * c + 1]);
+    }
+
+    // Agrégation des statistiques
+    // Les blocs voisins peuvent encore se chevaucher de quelques bases sur le
+    // contig (graine de reprise) : ces bases ne sont comptées qu'une fois
+    vector<long> longueursContigs;
+    vector<long> longueursAlignees;
+    vector<char> couverture(stats.longueurReference, 0);
+    long basesAligneesReference = 0;
+
+    for (size_t c = 0; c < contigs.size(); c++) {
+        int L = contigs[c].length();
+        const vector<BlocAlignement>& blocs = alignements[c];
+        longueursContigs.push_back(L);
+        stats.longueurTotale += L;
+
+        long basesAligneesContig = 0;
+        long longueurSegment = 0;
+        int misassemblagesContig = 0;
+        int finPrecedente = 0;
+        for (size_t b = 0; b < blocs.size(); b++) {
+            const BlocAlignement& bloc = blocs[b];
+            for (int p = bloc.debutReference; p < bloc.finReference; p++) {
+                couverture[p] = 1;
+            }
+
+            basesAligneesReference += bloc.finReference - bloc.debutReference;
+
+            if (b > 0) {
+                const BlocAlignement& precedent = blocs[b - 1];
+
+                // Changement de brin ou saut de diagonale entre blocs consécutifs :
+                // misassemblage, le segment aligné (pour le NGA50) est coupé
+                if (precedent.brinInverse != bloc.brinInverse ||
+                    labs(diagonale(bloc, L) - diagonale(precedent, L)) > ECART_MISASSEMBLAGE) {
+                    misassemblagesContig++;
+                    longueursAlignees.push_back(longueurSegment);
+                    longueurSegment = 0;
+                }
+            }
+
+            // Union des bases du contig couvertes par les blocs
+            int debutUtile = max(bloc.debutContig, finPrecedente);
+            if (bloc.finContig > debutUtile) {
+                basesAligneesContig += bloc.finContig - debutUtile;
+                longueurSegment += bloc.finContig - debutUtile;
+            }
+            finPrecedente = max(finPrecedente, bloc.finContig);
+        }
+        if (!blocs.empty()) {
+            longueursAlignees.push_back(longueurSegment);
+        }
+        stats.longueurNonAlignee += L - basesAligneesContig;
+        if (basesAligneesContig >= PART_ALIGNEE_MISASSEMBLAGE * L) {
+            stats.misassemblages += misassemblagesContig;
+        }
+    }
+
+    long basesCouvertes = 0;
+    for (char c : couverture) {
+        basesCouvertes += c;
+    }
+
+    stats.n50 = calculerNx50(longueursContigs, stats.longueurTotale);
+    stats.nga50 = calculerNx50(longueursAlignees, stats.longueurReference);
+    if (stats.longueurReference > 0) {
+        stats.fractionGenome = 100.0 * basesCouvertes / stats.longueurReference;
+    }
+    if (basesCouvertes > 0) {
+        stats.ratioDuplication = (double)basesAligneesReference / basesCouvertes;
+    }
+    return stats;
+}